@@ -16,16 +16,25 @@
 // that they store different kinds of information about each vertex and
 // about each edge; these two types are the type parameters to the
 // Digraph class template.
+//
+// An optional third type parameter chooses an instrumentation policy
+// (see DigraphInstrumentation.hpp).  The default, NoInstrumentation,
+// compiles away entirely.
 
 #ifndef DIGRAPH_HPP
 #define DIGRAPH_HPP
 
 #include <exception>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
+#include <queue>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
+#include "DigraphInstrumentation.hpp"
 
 
 
@@ -82,6 +91,11 @@ struct DigraphVertex
 // * VertexInfo, which specifies the kind of object stored for each vertex
 // * EdgeInfo, which specifies the kind of object stored for each edge
 //
+// and optionally a third, Instrumentation, which is told about each
+// operation and the work done inside it.  CountingInstrumentation records
+// call counts, latencies and work counters; NoInstrumentation (the
+// default) records nothing.
+//
 // You'll need to implement the member functions declared here; each has a
 // comment detailing how it is intended to work.
 //
@@ -89,7 +103,7 @@ struct DigraphVertex
 // Vertex numbers are not necessarily sequential and they are not necessarily
 // zero- or one-based.
 
-template <typename VertexInfo, typename EdgeInfo>
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation = NoInstrumentation>
 class Digraph
 {
 public:
@@ -202,7 +216,8 @@ public:
     // with each key k is the precedessor of that vertex chosen by
     // the algorithm.  For any vertex without a predecessor (e.g.,
     // a vertex that was never reached, or the start vertex itself),
-    // the value is simply a copy of the key.
+    // the value is simply a copy of the key.  If the start vertex
+    // does not exist, a DigraphException is thrown instead.
     std::map<int, int> findShortestPaths(
         int startVertex,
         std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
@@ -225,8 +240,8 @@ private:
 
 
 //// Default Constructor
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph()
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>::Digraph()
 {
     //// digraphMap variable is already initialized to be empty
 }
@@ -234,8 +249,8 @@ Digraph<VertexInfo, EdgeInfo>::Digraph()
 
 
 //// Copy Constructor (separate copies from source)
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>::Digraph(const Digraph& d)
     : digraphMap{d.digraphMap}
 {
 }
@@ -243,8 +258,8 @@ Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d)
 
 
 //// Move Constructor
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph(Digraph&& d) noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>::Digraph(Digraph&& d) noexcept
 {
     digraphMap.clear();
     std::swap(digraphMap,d.digraphMap);
@@ -252,16 +267,16 @@ Digraph<VertexInfo, EdgeInfo>::Digraph(Digraph&& d) noexcept
 
 
 //// Deconstructor
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::~Digraph() noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>::~Digraph() noexcept
 {
 }
 
 
 
 //// Self Assignment Operator
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Digraph& d)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>& Digraph<VertexInfo, EdgeInfo, Instrumentation>::operator=(const Digraph& d)
 {
     if (this != &d)
     {
@@ -274,8 +289,8 @@ Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Di
 
 
 //// Move Assignment Operator
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&& d) noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+Digraph<VertexInfo, EdgeInfo, Instrumentation>& Digraph<VertexInfo, EdgeInfo, Instrumentation>::operator=(Digraph&& d) noexcept
 {
     if (this != &d)
     {
@@ -287,9 +302,11 @@ Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&
 
 
 //// Returns a vector of all the vertices
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+std::vector<int> Digraph<VertexInfo, EdgeInfo, Instrumentation>::vertices() const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::vertices};
+
     //// If map is empty, return an empty vector.
     if (digraphMap.size() == 0)
     {
@@ -313,9 +330,11 @@ std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
 
 
 //// Returns vector of all edges (from and to)
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo, Instrumentation>::edges() const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::edges};
+
     if (digraphMap.size() == 0)
     {
         return std::vector<std::pair<int, int>>{};
@@ -326,6 +345,8 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 
         for (auto &vertex : digraphMap)
         {
+            Instrumentation::edgesScanned(DigraphOperation::edges, vertex.second.edges.size());
+
             //// &vertex.second.edges is the list of edges in DigraphVertex
             //// &edge is each DigraphEdge within the list
             for (auto &&edge : vertex.second.edges) /// might need &&
@@ -345,12 +366,14 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 
 
 //// Return all outgoing edges from specific vertex
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo, Instrumentation>::edges(int vertex) const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::outgoingEdges};
+
     try
     {
-        if (digraphMap.find(vertex)->first != vertex)
+        if (digraphMap.find(vertex) == digraphMap.end())
         {
             throw DigraphException{"Vertex does NOT exist."};
         }
@@ -363,8 +386,11 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
         {
             std::vector<std::pair<int, int>> allEdges{};
 
+            auto &outgoingEdges = digraphMap.find(vertex)->second.edges;
+            Instrumentation::edgesScanned(DigraphOperation::outgoingEdges, outgoingEdges.size());
+
             //// only get outgoing edges from specific vertex
-            for (auto &edge : digraphMap.find(vertex)->second.edges)
+            for (auto &edge : outgoingEdges)
             {
                 int fromV = edge.fromVertex;  
                 int toV = edge.toVertex; //  might need to use ->
@@ -379,18 +405,21 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::outgoingEdges);
         throw DigraphException{"Vertex does NOT exist."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+VertexInfo Digraph<VertexInfo, EdgeInfo, Instrumentation>::vertexInfo(int vertex) const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::vertexInfo};
+
     try
     {
-        if (digraphMap.find(vertex)->first != vertex)
+        if (digraphMap.find(vertex) == digraphMap.end())
         {
             throw DigraphException{"Vertex not found."};
         }
@@ -404,15 +433,18 @@ VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::vertexInfo);
         throw DigraphException{"Vertex not found."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+EdgeInfo Digraph<VertexInfo, EdgeInfo, Instrumentation>::edgeInfo(int fromVertex, int toVertex) const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::edgeInfo};
+
     try
     {
         if (digraphMap.count(fromVertex) == 0 || digraphMap.count(toVertex) == 0)
@@ -428,13 +460,20 @@ EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) c
             }
             else
             {
+                //// Counted locally and reported once, not once per edge
+                std::uint64_t scanned = 0;
+
                 for (auto &edge : digraphMap.find(fromVertex)->second.edges)
                 {
+                    ++scanned;
+
                     if (edge.fromVertex == fromVertex && edge.toVertex == toVertex)
                     {
+                        Instrumentation::edgesScanned(DigraphOperation::edgeInfo, scanned);
                         return edge.einfo;
                     }
                 }
+                Instrumentation::edgesScanned(DigraphOperation::edgeInfo, scanned);
             }
             throw DigraphException{"Vertices or edge does not exist."};
         }
@@ -442,22 +481,25 @@ EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) c
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::edgeInfo);
         throw DigraphException{"Vertices or edge does not exist."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+void Digraph<VertexInfo, EdgeInfo, Instrumentation>::addVertex(int vertex, const VertexInfo& vinfo)
 {
+    typename Instrumentation::Scope scope{DigraphOperation::addVertex};
+
     try
     {
         //// Check to see if vertex already exists in digraphMap and if so,
         //// throw an exception.
-        if (digraphMap.find(vertex)->first == vertex)
+        if (digraphMap.find(vertex) != digraphMap.end())
         {
-            throw;
+            throw DigraphException{"Vertex already exists."};
         }
 
         //// If vertex does not exist in digraphMap, then add it to the map
@@ -469,21 +511,24 @@ void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinf
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::addVertex);
         throw DigraphException{"Vertex already exists."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+void Digraph<VertexInfo, EdgeInfo, Instrumentation>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
 {
+    typename Instrumentation::Scope scope{DigraphOperation::addEdge};
+
     //// Use .find() memember function that will throw an exception if neither the from
     //// or to vertices exist OR if the edge within the graph already exists.
     try
     {
         //// Check vertices' existents before edge
-        if (digraphMap.find(fromVertex)->first == fromVertex && digraphMap.find(toVertex)->first == toVertex)
+        if (digraphMap.find(fromVertex) != digraphMap.end() && digraphMap.find(toVertex) != digraphMap.end())
         {
             //// Check edge existence
             if (digraphMap.find(fromVertex)->second.edges.size() == 0)
@@ -495,14 +540,20 @@ void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const
             else
             {
                 //// Check each edge struct in the list to see if the edge already exists
+                std::uint64_t scanned = 0;
+
                 for (auto &edge : digraphMap.find(fromVertex)->second.edges)
                 {
+                    ++scanned;
+
                     if (edge.fromVertex == fromVertex && edge.toVertex == toVertex)
                     {
+                        Instrumentation::edgesScanned(DigraphOperation::addEdge, scanned);
                         throw DigraphException{"Vertex may does not exist or edge already exists."};
 
                     }
                 }
+                Instrumentation::edgesScanned(DigraphOperation::addEdge, scanned);
                 //// If the throw was not activated then edge does NOT already exist so insert it into the list
                 DigraphEdge<EdgeInfo> newEdge{fromVertex, toVertex, einfo};
                 digraphMap.find(fromVertex)->second.edges.push_back(newEdge);
@@ -515,15 +566,18 @@ void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::addEdge);
         throw DigraphException{"Vertex may does not exist or edge already exists."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+void Digraph<VertexInfo, EdgeInfo, Instrumentation>::removeVertex(int vertex)
 {
+    typename Instrumentation::Scope scope{DigraphOperation::removeVertex};
+
     try
     {
         if (digraphMap.count(vertex) == 0)
@@ -539,9 +593,11 @@ void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
 
             digraphMap.erase(vertex);
             //// Remove all incoming edges in other vertices so check toVertex
-            for (auto v = digraphMap.begin(); v != digraphMap.begin(); v++)
+            for (auto v = digraphMap.begin(); v != digraphMap.end(); v++)
             {
                 std::list<DigraphEdge<EdgeInfo>> edgesWithoutVertex;
+                Instrumentation::edgesScanned(DigraphOperation::removeVertex, v->second.edges.size());
+
                 //// edges are the structs
                 for (struct DigraphEdge<EdgeInfo> &edge : v->second.edges)
                 {
@@ -558,15 +614,18 @@ void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::removeVertex);
         throw DigraphException{"Vertex already exists."};
     }
 }
 
 
 //// Remove specific edge within "fromVertex"
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+void Digraph<VertexInfo, EdgeInfo, Instrumentation>::removeEdge(int fromVertex, int toVertex)
 {
+    typename Instrumentation::Scope scope{DigraphOperation::removeEdge};
+
     try
     {
         if (digraphMap.count(fromVertex) == 0 || digraphMap.count(toVertex) == 0)
@@ -576,11 +635,14 @@ void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
         else
         {
             std::list<DigraphEdge<EdgeInfo>> edgesWithoutVertex;
+            auto &fromEdges = digraphMap.find(fromVertex)->second.edges;
+            Instrumentation::edgesScanned(DigraphOperation::removeEdge, fromEdges.size());
+
             //// edges are the structs
-            for (struct DigraphEdge<EdgeInfo> &edge : digraphMap.find(fromVertex)->second.edges)
+            for (struct DigraphEdge<EdgeInfo> &edge : fromEdges)
             {
                 //// Don't add the edge we want to remove
-                if (edge.fromVertex != fromVertex && edge.fromVertex != toVertex)
+                if (edge.fromVertex != fromVertex || edge.toVertex != toVertex)
                 {
                     edgesWithoutVertex.push_back(edge);
                 }
@@ -602,15 +664,18 @@ void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::removeEdge);
         throw DigraphException{"At least one vertex is not found OR edge does not exist."};
     }
 }
 
 
 //// Returns the amount of vertices in the map
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+int Digraph<VertexInfo, EdgeInfo, Instrumentation>::vertexCount() const noexcept
 {
+    typename Instrumentation::Scope scope{DigraphOperation::vertexCount};
+
     if (digraphMap.size() == 0)
     {
         return 0;
@@ -623,9 +688,11 @@ int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
 
 
 //// Returns the total amount of all edges across all vertices
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+int Digraph<VertexInfo, EdgeInfo, Instrumentation>::edgeCount() const noexcept
 {
+    typename Instrumentation::Scope scope{DigraphOperation::edgeCount};
+
     if (digraphMap.empty() == true)
     {
         return 0;
@@ -635,6 +702,7 @@ int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
         int totalEdgeCount = 0;
         for (auto &vertex : digraphMap)
         {
+            Instrumentation::edgesScanned(DigraphOperation::edgeCount, vertex.second.edges.size());
             totalEdgeCount += vertex.second.edges.size();
         }
         return totalEdgeCount;
@@ -643,35 +711,177 @@ int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
 
 
 //// Returns total amount of outgoing edges for a specific vertex
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+int Digraph<VertexInfo, EdgeInfo, Instrumentation>::edgeCount(int vertex) const
 {
+    typename Instrumentation::Scope scope{DigraphOperation::outgoingEdgeCount};
+
     try
     {
-        return digraphMap.find(vertex)->second.edges.size();   
+        if (digraphMap.find(vertex) == digraphMap.end())
+        {
+            throw DigraphException{"Vertex does not exist."};
+        }
+        return digraphMap.find(vertex)->second.edges.size();
     }
     catch(...)
     {
+        Instrumentation::exceptionThrown(DigraphOperation::outgoingEdgeCount);
         throw DigraphException{"Vertex does not exist."};
     }
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
+//// Strongly connected iff every vertex is reachable from one vertex
+//// along the edges AND along the reversed edges, so two traversals
+//// from the first vertex are enough.
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+bool Digraph<VertexInfo, EdgeInfo, Instrumentation>::isStronglyConnected() const
 {
-    return false;
+    typename Instrumentation::Scope scope{DigraphOperation::isStronglyConnected};
+
+    if (digraphMap.empty() == true)
+    {
+        return true;
+    }
+
+    //// Build the reversed adjacency lists once
+    std::map<int, std::vector<int>> reversed;
+    for (auto &vertex : digraphMap)
+    {
+        Instrumentation::edgesScanned(DigraphOperation::isStronglyConnected, vertex.second.edges.size());
+
+        for (auto &edge : vertex.second.edges)
+        {
+            reversed[edge.toVertex].push_back(edge.fromVertex);
+        }
+    }
+
+    int startVertex = digraphMap.begin()->first;
+
+    //// Forward traversal
+    std::map<int, bool> visited;
+    std::vector<int> toVisit{startVertex};
+    visited[startVertex] = true;
+
+    while (toVisit.empty() == false)
+    {
+        int current = toVisit.back();
+        toVisit.pop_back();
+        Instrumentation::vertexVisited();
+
+        auto &currentEdges = digraphMap.find(current)->second.edges;
+        Instrumentation::edgesScanned(DigraphOperation::isStronglyConnected, currentEdges.size());
+
+        for (auto &edge : currentEdges)
+        {
+            if (visited[edge.toVertex] == false)
+            {
+                visited[edge.toVertex] = true;
+                toVisit.push_back(edge.toVertex);
+            }
+        }
+    }
+
+    if (visited.size() != digraphMap.size())
+    {
+        return false;
+    }
+
+    //// Backward traversal over the reversed edges
+    visited.clear();
+    toVisit.push_back(startVertex);
+    visited[startVertex] = true;
+
+    while (toVisit.empty() == false)
+    {
+        int current = toVisit.back();
+        toVisit.pop_back();
+        Instrumentation::vertexVisited();
+
+        auto &incoming = reversed[current];
+        Instrumentation::edgesScanned(DigraphOperation::isStronglyConnected, incoming.size());
+
+        for (int fromV : incoming)
+        {
+            if (visited[fromV] == false)
+            {
+                visited[fromV] = true;
+                toVisit.push_back(fromV);
+            }
+        }
+    }
+
+    return visited.size() == digraphMap.size();
 }
 
 
 
-template <typename VertexInfo, typename EdgeInfo>
-std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+template <typename VertexInfo, typename EdgeInfo, typename Instrumentation>
+std::map<int, int> Digraph<VertexInfo, EdgeInfo, Instrumentation>::findShortestPaths(
     int startVertex,
     std::function<double(const EdgeInfo&)> edgeWeightFunc) const
 {
-    return std::map<int, int>{};
+    typename Instrumentation::Scope scope{DigraphOperation::findShortestPaths};
+
+    if (digraphMap.find(startVertex) == digraphMap.end())
+    {
+        Instrumentation::exceptionThrown(DigraphOperation::findShortestPaths);
+        throw DigraphException{"Vertex does not exist."};
+    }
+
+    //// Every vertex starts out as its own predecessor, infinitely far away
+    std::map<int, int> predecessors;
+    std::map<int, double> distances;
+    std::map<int, bool> known;
+
+    for (auto &vertex : digraphMap)
+    {
+        predecessors[vertex.first] = vertex.first;
+        distances[vertex.first] = std::numeric_limits<double>::infinity();
+        known[vertex.first] = false;
+    }
+
+    distances[startVertex] = 0.0;
+
+    //// Min-heap of (distance, vertex); stale entries are skipped when popped
+    //// instead of being decreased in place.
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    pq.push(QueueEntry{0.0, startVertex});
+    Instrumentation::heapPush();
+
+    while (pq.empty() == false)
+    {
+        int current = pq.top().second;
+        pq.pop();
+        Instrumentation::heapPop();
+
+        if (known[current] == true)
+        {
+            continue;
+        }
+        known[current] = true;
+
+        auto &currentEdges = digraphMap.find(current)->second.edges;
+        Instrumentation::edgesScanned(DigraphOperation::findShortestPaths, currentEdges.size());
+
+        for (auto &edge : currentEdges)
+        {
+            double newDistance = distances[current] + edgeWeightFunc(edge.einfo);
+
+            if (newDistance < distances[edge.toVertex])
+            {
+                distances[edge.toVertex] = newDistance;
+                predecessors[edge.toVertex] = current;
+                pq.push(QueueEntry{newDistance, edge.toVertex});
+                Instrumentation::heapPush();
+            }
+        }
+    }
+
+    return predecessors;
 }
 
 
@@ -0,0 +1,471 @@
+// DigraphInstrumentation.hpp
+//
+// Instrumentation policies for the Digraph class template.  A policy is
+// passed as Digraph's third type parameter and is told about every
+// member function call other than construction, copying and assignment
+// (one DigraphOperation each), along with the work done inside it
+// (edges scanned and exceptions thrown, per operation; heap pushes and
+// pops; vertices visited).
+//
+// There are two policies:
+//
+// * NoInstrumentation, the default, whose hooks are all empty inline
+//   functions, so a Digraph that uses it compiles to exactly the same
+//   code as one with no hooks at all.
+//
+// * CountingInstrumentation, which keeps call counts, work counters and
+//   latency histograms in per-thread counter blocks.  Each thread only
+//   ever writes to its own block, so recording is a plain load and store
+//   with no locking; snapshot() sums every thread's block (plus the
+//   blocks of threads that have already exited) under a lock.  The
+//   resulting Snapshot can be written out in the Prometheus text format
+//   for a metrics agent to scrape.
+
+#ifndef DIGRAPHINSTRUMENTATION_HPP
+#define DIGRAPHINSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+
+
+// The Digraph operations that are instrumented.  Count is not an
+// operation; it's the number of operations, used to size arrays.
+enum class DigraphOperation
+{
+    vertices,
+    edges,
+    outgoingEdges,
+    vertexInfo,
+    edgeInfo,
+    addVertex,
+    addEdge,
+    removeVertex,
+    removeEdge,
+    vertexCount,
+    edgeCount,
+    outgoingEdgeCount,
+    isStronglyConnected,
+    findShortestPaths,
+    Count
+};
+
+
+constexpr int digraphOperationCount = static_cast<int>(DigraphOperation::Count);
+
+
+inline const char* digraphOperationName(DigraphOperation op) noexcept
+{
+    static const char* const names[digraphOperationCount]{
+        "vertices",
+        "edges",
+        "outgoingEdges",
+        "vertexInfo",
+        "edgeInfo",
+        "addVertex",
+        "addEdge",
+        "removeVertex",
+        "removeEdge",
+        "vertexCount",
+        "edgeCount",
+        "outgoingEdgeCount",
+        "isStronglyConnected",
+        "findShortestPaths"
+    };
+
+    return names[static_cast<int>(op)];
+}
+
+
+
+// NoInstrumentation is the default policy; it records nothing.
+struct NoInstrumentation
+{
+    // A Scope lives for the duration of one operation.
+    struct Scope
+    {
+        explicit Scope(DigraphOperation) noexcept
+        {
+        }
+    };
+
+    static void exceptionThrown(DigraphOperation) noexcept
+    {
+    }
+
+    static void edgesScanned(DigraphOperation, std::uint64_t) noexcept
+    {
+    }
+
+    static void heapPush() noexcept
+    {
+    }
+
+    static void heapPop() noexcept
+    {
+    }
+
+    static void vertexVisited() noexcept
+    {
+    }
+};
+
+
+
+// CountingInstrumentation records everything into per-thread counters
+// that are shared by every Digraph using this policy.
+class CountingInstrumentation
+{
+public:
+    // Latencies are whole nanoseconds bucketed by powers of two: bucket 0
+    // holds 0 and 1 ns and bucket i holds 2^i through 2^(i+1) - 1 ns,
+    // except that the last bucket also holds everything longer.  Bucket i
+    // is exported with le="2^(i+1) - 1", its largest value.
+    static constexpr int latencyBuckets = 32;
+
+    using Counts = std::array<std::uint64_t, digraphOperationCount>;
+    using Histogram = std::array<std::uint64_t, latencyBuckets>;
+
+    // A Snapshot is the sum of every thread's counters at one moment.
+    struct Snapshot
+    {
+        Counts calls{};
+        Counts exceptions{};
+        Counts edgesScanned{};
+        Counts latencyTotalNs{};
+        std::array<Histogram, digraphOperationCount> latency{};
+
+        std::uint64_t heapPushes = 0;
+        std::uint64_t heapPops = 0;
+        std::uint64_t verticesVisited = 0;
+
+        // writePrometheus() writes this Snapshot in the Prometheus text
+        // exposition format.
+        void writePrometheus(std::ostream& out) const;
+    };
+
+    class Scope
+    {
+    public:
+        explicit Scope(DigraphOperation operation) noexcept;
+        ~Scope() noexcept;
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        DigraphOperation op;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static void exceptionThrown(DigraphOperation op) noexcept;
+    static void edgesScanned(DigraphOperation op, std::uint64_t count) noexcept;
+    static void heapPush() noexcept;
+    static void heapPop() noexcept;
+    static void vertexVisited() noexcept;
+
+    // snapshot() returns the counters summed across all threads, live
+    // or exited, since the program started.
+    static Snapshot snapshot();
+
+    static int latencyBucket(std::uint64_t ns) noexcept;
+
+private:
+    using Counter = std::atomic<std::uint64_t>;
+
+    // Only the owning thread ever writes to its ThreadCounters, so a
+    // relaxed load and store is enough; the atomics are only there so
+    // that snapshot() can read them from another thread.
+    struct ThreadCounters
+    {
+        Counter calls[digraphOperationCount]{};
+        Counter exceptions[digraphOperationCount]{};
+        Counter edgesScanned[digraphOperationCount]{};
+        Counter latencyTotalNs[digraphOperationCount]{};
+        Counter latency[digraphOperationCount][latencyBuckets]{};
+
+        Counter heapPushes{0};
+        Counter heapPops{0};
+        Counter verticesVisited{0};
+
+        void addTo(Snapshot& s) const noexcept;
+    };
+
+    // The registry's lock is only taken when a thread starts or exits
+    // and by snapshot(), so a spin lock is plenty; unlike std::mutex,
+    // locking it can't throw, which the noexcept hooks depend on.
+    class SpinLock
+    {
+    public:
+        void lock() noexcept
+        {
+            while (flag.test_and_set(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock() noexcept
+        {
+            flag.clear(std::memory_order_release);
+        }
+
+    private:
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    };
+
+    struct Registry
+    {
+        SpinLock lock;
+        std::vector<const ThreadCounters*> live;
+        Snapshot retired;
+    };
+
+    // Registers its counters on construction; on thread exit, folds them
+    // into the registry's retired totals so they aren't lost.  Neither
+    // can throw (see the constructor), since the first hook call on a
+    // thread can come from a noexcept Scope destructor during unwinding.
+    struct ThreadHandle
+    {
+        ThreadHandle() noexcept;
+        ~ThreadHandle() noexcept;
+
+        ThreadCounters counters;
+        bool registered = false;
+    };
+
+    static void bump(Counter& c, std::uint64_t n) noexcept;
+    static Registry& registry();
+    static ThreadCounters& local();
+};
+
+
+
+inline void CountingInstrumentation::bump(Counter& c, std::uint64_t n) noexcept
+{
+    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+
+//// Deliberately leaked, so it outlives every thread and every static
+//// destructor; threads exiting (and scrapers calling snapshot()) during
+//// static destruction would otherwise use a destroyed registry.
+inline CountingInstrumentation::Registry& CountingInstrumentation::registry()
+{
+    static Registry* r = new Registry;
+    return *r;
+}
+
+
+inline CountingInstrumentation::ThreadCounters& CountingInstrumentation::local()
+{
+    thread_local ThreadHandle handle;
+    return handle.counters;
+}
+
+
+//// Allocating the registry and growing the live list can throw
+//// std::bad_alloc.  Rather than let that reach a noexcept hook (and
+//// std::terminate), a thread that can't register just isn't registered:
+//// it still counts into its own block, but snapshot() won't see it.
+inline CountingInstrumentation::ThreadHandle::ThreadHandle() noexcept
+{
+    try
+    {
+        Registry& r = registry();
+        std::lock_guard<SpinLock> guard{r.lock};
+        r.live.push_back(&counters);
+        registered = true;
+    }
+    catch (...)
+    {
+    }
+}
+
+
+inline CountingInstrumentation::ThreadHandle::~ThreadHandle() noexcept
+{
+    if (registered == false)
+    {
+        return;
+    }
+
+    //// Nothing here can throw: the registry already exists, the lock
+    //// doesn't throw, and folding and erasing don't allocate.
+    Registry& r = registry();
+    std::lock_guard<SpinLock> guard{r.lock};
+    counters.addTo(r.retired);
+    r.live.erase(std::remove(r.live.begin(), r.live.end(), &counters), r.live.end());
+}
+
+
+inline void CountingInstrumentation::ThreadCounters::addTo(Snapshot& s) const noexcept
+{
+    for (int op = 0; op < digraphOperationCount; ++op)
+    {
+        s.calls[op] += calls[op].load(std::memory_order_relaxed);
+        s.exceptions[op] += exceptions[op].load(std::memory_order_relaxed);
+        s.edgesScanned[op] += edgesScanned[op].load(std::memory_order_relaxed);
+        s.latencyTotalNs[op] += latencyTotalNs[op].load(std::memory_order_relaxed);
+
+        for (int b = 0; b < latencyBuckets; ++b)
+        {
+            s.latency[op][b] += latency[op][b].load(std::memory_order_relaxed);
+        }
+    }
+
+    s.heapPushes += heapPushes.load(std::memory_order_relaxed);
+    s.heapPops += heapPops.load(std::memory_order_relaxed);
+    s.verticesVisited += verticesVisited.load(std::memory_order_relaxed);
+}
+
+
+inline int CountingInstrumentation::latencyBucket(std::uint64_t ns) noexcept
+{
+    int bucket = 0;
+
+    while (ns > 1 && bucket < latencyBuckets - 1)
+    {
+        ns >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+
+inline CountingInstrumentation::Scope::Scope(DigraphOperation operation) noexcept
+    : op{operation}, start{std::chrono::steady_clock::now()}
+{
+}
+
+
+inline CountingInstrumentation::Scope::~Scope() noexcept
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    std::uint64_t ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+    ThreadCounters& c = local();
+    int i = static_cast<int>(op);
+
+    bump(c.calls[i], 1);
+    bump(c.latencyTotalNs[i], ns);
+    bump(c.latency[i][latencyBucket(ns)], 1);
+}
+
+
+inline void CountingInstrumentation::exceptionThrown(DigraphOperation op) noexcept
+{
+    bump(local().exceptions[static_cast<int>(op)], 1);
+}
+
+
+inline void CountingInstrumentation::edgesScanned(DigraphOperation op, std::uint64_t count) noexcept
+{
+    bump(local().edgesScanned[static_cast<int>(op)], count);
+}
+
+
+inline void CountingInstrumentation::heapPush() noexcept
+{
+    bump(local().heapPushes, 1);
+}
+
+
+inline void CountingInstrumentation::heapPop() noexcept
+{
+    bump(local().heapPops, 1);
+}
+
+
+inline void CountingInstrumentation::vertexVisited() noexcept
+{
+    bump(local().verticesVisited, 1);
+}
+
+
+inline CountingInstrumentation::Snapshot CountingInstrumentation::snapshot()
+{
+    Registry& r = registry();
+    std::lock_guard<SpinLock> guard{r.lock};
+
+    Snapshot s = r.retired;
+
+    for (const ThreadCounters* c : r.live)
+    {
+        c->addTo(s);
+    }
+
+    return s;
+}
+
+
+inline void CountingInstrumentation::Snapshot::writePrometheus(std::ostream& out) const
+{
+    out << "# TYPE digraph_operation_calls_total counter\n";
+    for (int op = 0; op < digraphOperationCount; ++op)
+    {
+        out << "digraph_operation_calls_total{operation=\""
+            << digraphOperationName(static_cast<DigraphOperation>(op)) << "\"} "
+            << calls[op] << "\n";
+    }
+
+    out << "# TYPE digraph_operation_exceptions_total counter\n";
+    for (int op = 0; op < digraphOperationCount; ++op)
+    {
+        out << "digraph_operation_exceptions_total{operation=\""
+            << digraphOperationName(static_cast<DigraphOperation>(op)) << "\"} "
+            << exceptions[op] << "\n";
+    }
+
+    out << "# TYPE digraph_edges_scanned_total counter\n";
+    for (int op = 0; op < digraphOperationCount; ++op)
+    {
+        out << "digraph_edges_scanned_total{operation=\""
+            << digraphOperationName(static_cast<DigraphOperation>(op)) << "\"} "
+            << edgesScanned[op] << "\n";
+    }
+
+    //// Prometheus buckets are cumulative and labeled by the largest value
+    //// they hold (le means "less than or equal")
+    out << "# TYPE digraph_operation_latency_ns histogram\n";
+    for (int op = 0; op < digraphOperationCount; ++op)
+    {
+        const char* name = digraphOperationName(static_cast<DigraphOperation>(op));
+        std::uint64_t cumulative = 0;
+
+        for (int b = 0; b < latencyBuckets - 1; ++b)
+        {
+            cumulative += latency[op][b];
+            out << "digraph_operation_latency_ns_bucket{operation=\"" << name
+                << "\",le=\"" << (std::uint64_t{1} << (b + 1)) - 1 << "\"} "
+                << cumulative << "\n";
+        }
+
+        out << "digraph_operation_latency_ns_bucket{operation=\"" << name
+            << "\",le=\"+Inf\"} " << calls[op] << "\n";
+        out << "digraph_operation_latency_ns_sum{operation=\"" << name << "\"} "
+            << latencyTotalNs[op] << "\n";
+        out << "digraph_operation_latency_ns_count{operation=\"" << name << "\"} "
+            << calls[op] << "\n";
+    }
+
+    out << "# TYPE digraph_heap_pushes_total counter\n";
+    out << "digraph_heap_pushes_total " << heapPushes << "\n";
+    out << "# TYPE digraph_heap_pops_total counter\n";
+    out << "digraph_heap_pops_total " << heapPops << "\n";
+    out << "# TYPE digraph_vertices_visited_total counter\n";
+    out << "digraph_vertices_visited_total " << verticesVisited << "\n";
+}
+
+
+
+#endif
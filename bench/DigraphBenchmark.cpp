@@ -0,0 +1,508 @@
+// DigraphBenchmark.cpp
+//
+// Benchmarks for the Digraph class template.  Each synthetic graph from
+// GraphGenerators.hpp is built into a Digraph<int, double> and then every
+// operation of interest is timed against it.  Results are written as a
+// single JSON document so they can be stored and compared over time.
+//
+// Every measurement is run once to warm up and then a number of times
+// more; the JSON reports the minimum, median and maximum of those runs.
+// Anything a run needs (a fresh graph, a copy to remove from, the inputs
+// to query with) is prepared before its timer starts.
+//
+// Usage:
+//
+//     digraph_bench [--scale small|medium|large] [--seed N]
+//                   [--repetitions N] [--out FILE]
+//
+// --scale may be given more than once; the default is small and medium
+// (large takes several minutes, mostly on the hub graph).  Without
+// --repetitions, each scale uses its own count.  Without --out, the JSON
+// goes to standard output.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../Digraph.hpp"
+#include "GraphGenerators.hpp"
+
+
+
+namespace
+{
+    using BenchGraph = Digraph<int, double>;
+    using Clock = std::chrono::steady_clock;
+
+
+    // Written to after every timed loop so the compiler can't throw the
+    // work away.
+    volatile std::uint64_t sink = 0;
+
+
+    struct Result
+    {
+        std::string graph;
+        std::string scale;
+        int vertices;
+        int edges;
+        std::string operation;
+
+        // Operations per run; each run's time covers all of them
+        std::uint64_t operations;
+
+        int repetitions;
+        double minNs;
+        double medianNs;
+        double maxNs;
+    };
+
+
+    struct Scale
+    {
+        std::string name;
+        int gridSide;
+        int erdosRenyiVertices;
+        int rmatScale;
+        int hubVertices;
+
+        // How many times each query is repeated (or sampled) per graph
+        int samples;
+
+        // How many vertices removeVertex() is timed on; each call scans
+        // every adjacency list, so this is kept small.
+        int vertexRemovals;
+
+        // How many start vertices findShortestPaths() is run from
+        int shortestPathRuns;
+
+        // How many timed runs each measurement gets, after the warm-up
+        int repetitions;
+    };
+
+
+    const std::vector<Scale> allScales{
+        {"small", 32, 1000, 10, 1000, 2000, 50, 8, 9},
+        {"medium", 100, 10000, 14, 5000, 5000, 20, 4, 5},
+        {"large", 316, 100000, 17, 20000, 10000, 10, 2, 3}
+    };
+
+
+    struct Timing
+    {
+        double minNs;
+        double medianNs;
+        double maxNs;
+    };
+
+
+    // measure() calls setup() and then times run(), once to warm up and
+    // then repetitions more times.  Only run() is inside the timer.
+    template <typename Setup, typename Run>
+    Timing measure(int repetitions, Setup setup, Run run)
+    {
+        std::vector<double> times;
+
+        for (int i = 0; i <= repetitions; ++i)
+        {
+            setup();
+
+            auto start = Clock::now();
+            run();
+            auto end = Clock::now();
+
+            if (i > 0)
+            {
+                times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+
+        std::sort(times.begin(), times.end());
+        return Timing{times.front(), times[times.size() / 2], times.back()};
+    }
+
+
+    template <typename Run>
+    Timing measure(int repetitions, Run run)
+    {
+        return measure(repetitions, [] {}, run);
+    }
+
+
+    BenchGraph buildVertices(const GeneratedGraph& g)
+    {
+        BenchGraph d;
+
+        for (int v = 0; v < g.vertexCount; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        return d;
+    }
+
+
+    void addEdges(BenchGraph& d, const GeneratedGraph& g)
+    {
+        for (const GeneratedEdge& e : g.edges)
+        {
+            d.addEdge(e.fromVertex, e.toVertex, e.weight);
+        }
+    }
+
+
+    void benchmarkGraph(
+        const GeneratedGraph& g, const Scale& scale, std::uint64_t seed,
+        std::vector<Result>& results)
+    {
+        int vertexCount = g.vertexCount;
+        int edgeCount = static_cast<int>(g.edges.size());
+
+        int repetitions = scale.repetitions;
+
+        auto record = [&](const std::string& operation, std::uint64_t operations, Timing t)
+        {
+            results.push_back(Result{
+                g.name, scale.name, vertexCount, edgeCount, operation, operations,
+                repetitions, t.minNs, t.medianNs, t.maxNs});
+        };
+
+        std::mt19937_64 rng{seed};
+        std::uniform_int_distribution<int> anyVertex{0, vertexCount - 1};
+        std::uniform_int_distribution<std::size_t> anyEdge{0, g.edges.size() - 1};
+
+
+        // Construction; every run starts again from an empty graph (for
+        // addVertex) or one with all the vertices but no edges (for addEdge).
+
+        BenchGraph d;
+
+        record("addVertex", vertexCount, measure(repetitions,
+            [&] { d = BenchGraph{}; },
+            [&] { d = buildVertices(g); }));
+
+        record("addEdge", edgeCount, measure(repetitions,
+            [&] { d = buildVertices(g); },
+            [&] { addEdges(d, g); }));
+
+
+        // Enumeration
+
+        int samples = scale.samples;
+        int enumerations = std::max(1, samples / 100);
+
+        record("vertices", enumerations, measure(repetitions, [&]
+        {
+            for (int i = 0; i < enumerations; ++i)
+            {
+                sink = sink + d.vertices().size();
+            }
+        }));
+
+        record("edges", enumerations, measure(repetitions, [&]
+        {
+            for (int i = 0; i < enumerations; ++i)
+            {
+                sink = sink + d.edges().size();
+            }
+        }));
+
+
+        // edgeInfo() on edges that exist, on (from, to) pairs of existing
+        // vertices where the edge does not, and on pairs where one of the
+        // vertices doesn't exist.  Both kinds of miss end in an exception,
+        // but they give up at different points.
+
+        std::vector<std::pair<int, int>> hits;
+        std::vector<std::pair<int, int>> misses;
+        std::vector<std::pair<int, int>> vertexMisses;
+        graphgen::EdgeSet present;
+
+        for (const GeneratedEdge& e : g.edges)
+        {
+            present.insert(e.fromVertex, e.toVertex);
+        }
+
+        for (int i = 0; i < samples; ++i)
+        {
+            const GeneratedEdge& e = g.edges[anyEdge(rng)];
+            hits.push_back({e.fromVertex, e.toVertex});
+        }
+
+        while (static_cast<int>(misses.size()) < samples)
+        {
+            int fromV = anyVertex(rng);
+            int toV = anyVertex(rng);
+
+            if (present.contains(fromV, toV) == false)
+            {
+                misses.push_back({fromV, toV});
+            }
+        }
+
+        //// Alternate between a missing "from" and a missing "to" vertex
+        for (int i = 0; i < samples; ++i)
+        {
+            int missing = vertexCount + i;
+
+            if (i % 2 == 0)
+            {
+                vertexMisses.push_back({missing, anyVertex(rng)});
+            }
+            else
+            {
+                vertexMisses.push_back({anyVertex(rng), missing});
+            }
+        }
+
+        auto timeMisses = [&](const std::vector<std::pair<int, int>>& pairs)
+        {
+            return measure(repetitions, [&]
+            {
+                std::uint64_t thrown = 0;
+
+                for (auto& p : pairs)
+                {
+                    try
+                    {
+                        sink = sink + static_cast<std::uint64_t>(d.edgeInfo(p.first, p.second));
+                    }
+                    catch (DigraphException&)
+                    {
+                        ++thrown;
+                    }
+                }
+                sink = sink + thrown;
+            });
+        };
+
+        record("edgeInfo_hit", hits.size(), measure(repetitions, [&]
+        {
+            double total = 0.0;
+
+            for (auto& p : hits)
+            {
+                total += d.edgeInfo(p.first, p.second);
+            }
+            sink = sink + static_cast<std::uint64_t>(total);
+        }));
+
+        record("edgeInfo_miss", misses.size(), timeMisses(misses));
+        record("edgeInfo_miss_vertex", vertexMisses.size(), timeMisses(vertexMisses));
+
+
+        // Algorithms
+
+        auto weight = [](const double& einfo) { return einfo; };
+
+        std::vector<int> startVertices;
+
+        for (int i = 0; i < scale.shortestPathRuns; ++i)
+        {
+            startVertices.push_back(anyVertex(rng));
+        }
+
+        record("findShortestPaths", startVertices.size(), measure(repetitions, [&]
+        {
+            for (int start : startVertices)
+            {
+                sink = sink + d.findShortestPaths(start, weight).size();
+            }
+        }));
+
+        record("isStronglyConnected", 1, measure(repetitions, [&]
+        {
+            sink = sink + d.isStronglyConnected();
+        }));
+
+
+        // Removal; every run removes from a fresh copy of the graph, and
+        // making the copy is not timed.
+
+        std::vector<std::pair<int, int>> edgesToRemove;
+        {
+            std::vector<GeneratedEdge> shuffled = g.edges;
+            std::shuffle(shuffled.begin(), shuffled.end(), rng);
+            shuffled.resize(std::min<std::size_t>(shuffled.size(), samples));
+
+            for (const GeneratedEdge& e : shuffled)
+            {
+                edgesToRemove.push_back({e.fromVertex, e.toVertex});
+            }
+        }
+
+        BenchGraph copy;
+
+        record("removeEdge", edgesToRemove.size(), measure(repetitions,
+            [&] { copy = d; },
+            [&]
+            {
+                for (auto& p : edgesToRemove)
+                {
+                    copy.removeEdge(p.first, p.second);
+                }
+            }));
+
+        std::vector<int> verticesToRemove;
+        {
+            std::vector<int> all = d.vertices();
+            std::shuffle(all.begin(), all.end(), rng);
+            all.resize(std::min<std::size_t>(all.size(), scale.vertexRemovals));
+            verticesToRemove = all;
+        }
+
+        record("removeVertex", verticesToRemove.size(), measure(repetitions,
+            [&] { copy = d; },
+            [&]
+            {
+                for (int v : verticesToRemove)
+                {
+                    copy.removeVertex(v);
+                }
+            }));
+    }
+
+
+    void writeJson(
+        std::ostream& out, std::uint64_t seed, const std::vector<Result>& results)
+    {
+        out << "{\n";
+        out << "  \"benchmark\": \"digraph\",\n";
+        out << "  \"seed\": " << seed << ",\n";
+        out << "  \"results\": [\n";
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            double perOp = r.operations == 0 ? 0.0 : r.medianNs / r.operations;
+
+            out << "    {"
+                << "\"graph\": \"" << r.graph << "\", "
+                << "\"scale\": \"" << r.scale << "\", "
+                << "\"vertices\": " << r.vertices << ", "
+                << "\"edges\": " << r.edges << ", "
+                << "\"operation\": \"" << r.operation << "\", "
+                << "\"operations\": " << r.operations << ", "
+                << "\"repetitions\": " << r.repetitions << ", "
+                << "\"min_ns\": " << static_cast<std::uint64_t>(r.minNs) << ", "
+                << "\"median_ns\": " << static_cast<std::uint64_t>(r.medianNs) << ", "
+                << "\"max_ns\": " << static_cast<std::uint64_t>(r.maxNs) << ", "
+                << "\"ns_per_op\": " << perOp
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+
+    void usage()
+    {
+        std::cerr << "usage: digraph_bench [--scale small|medium|large] [--seed N] "
+                  << "[--repetitions N] [--out FILE]\n";
+    }
+}
+
+
+
+int main(int argc, char** argv)
+{
+    std::vector<Scale> scales;
+    std::uint64_t seed = 46;
+    int repetitions = 0;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--scale" && i + 1 < argc)
+        {
+            std::string name = argv[++i];
+            auto found = std::find_if(allScales.begin(), allScales.end(),
+                [&](const Scale& s) { return s.name == name; });
+
+            if (found == allScales.end())
+            {
+                usage();
+                return 1;
+            }
+            scales.push_back(*found);
+        }
+        else if (arg == "--seed" && i + 1 < argc)
+        {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--repetitions" && i + 1 < argc)
+        {
+            repetitions = std::atoi(argv[++i]);
+
+            if (repetitions < 1)
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--out" && i + 1 < argc)
+        {
+            outPath = argv[++i];
+        }
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (scales.empty())
+    {
+        scales = {allScales[0], allScales[1]};
+    }
+
+    std::vector<Result> results;
+
+    for (Scale& scale : scales)
+    {
+        if (repetitions != 0)
+        {
+            scale.repetitions = repetitions;
+        }
+
+        std::vector<GeneratedGraph> graphs{
+            graphgen::grid(scale.gridSide, scale.gridSide, seed),
+            graphgen::erdosRenyi(scale.erdosRenyiVertices, 4, seed),
+            graphgen::rmat(scale.rmatScale, 8, seed),
+            graphgen::hubs(scale.hubVertices, 4, 2, seed)
+        };
+
+        for (const GeneratedGraph& g : graphs)
+        {
+            std::cerr << "benchmarking " << g.name << " (" << scale.name << ")\n";
+            benchmarkGraph(g, scale, seed, results);
+        }
+    }
+
+    if (outPath.empty())
+    {
+        writeJson(std::cout, seed, results);
+    }
+    else
+    {
+        std::ofstream out{outPath};
+
+        if (!out)
+        {
+            std::cerr << "could not open " << outPath << "\n";
+            return 1;
+        }
+        writeJson(out, seed, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+// GraphGenerators.hpp
+//
+// Synthetic graph generators used by the Digraph benchmarks.  Each
+// generator produces a GeneratedGraph, which is just a vertex count and
+// a list of distinct edges, so the cost of building a Digraph out of it
+// can be timed separately from the cost of generating it.
+//
+// Vertices are always numbered 0 .. vertexCount - 1.  Every generator
+// takes a seed, so the same arguments always produce the same graph.
+
+#ifndef GRAPHGENERATORS_HPP
+#define GRAPHGENERATORS_HPP
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+
+// A GeneratedEdge is the "from" vertex, the "to" vertex and a weight,
+// which is what the benchmarks store as the Digraph's EdgeInfo.
+struct GeneratedEdge
+{
+    int fromVertex;
+    int toVertex;
+    double weight;
+};
+
+
+
+struct GeneratedGraph
+{
+    std::string name;
+    int vertexCount;
+    std::vector<GeneratedEdge> edges;
+};
+
+
+
+namespace graphgen
+{
+    // Keeps track of which (from, to) pairs have already been generated,
+    // since Digraph::addEdge() refuses duplicate edges.
+    class EdgeSet
+    {
+    public:
+        bool insert(int fromVertex, int toVertex)
+        {
+            return seen.insert(key(fromVertex, toVertex)).second;
+        }
+
+        bool contains(int fromVertex, int toVertex) const
+        {
+            return seen.count(key(fromVertex, toVertex)) != 0;
+        }
+
+    private:
+        static std::uint64_t key(int fromVertex, int toVertex)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(fromVertex)) << 32)
+                | static_cast<std::uint32_t>(toVertex);
+        }
+
+        std::unordered_set<std::uint64_t> seen;
+    };
+
+
+    inline void addEdge(
+        GeneratedGraph& g, EdgeSet& seen, int fromVertex, int toVertex, double weight)
+    {
+        if (seen.insert(fromVertex, toVertex))
+        {
+            g.edges.push_back(GeneratedEdge{fromVertex, toVertex, weight});
+        }
+    }
+
+
+
+    // grid() builds a rows x cols road network: each intersection has
+    // a two-way street to each of its (up to four) neighbors, with a
+    // random length between 1 and 10.  Grids are strongly connected.
+    inline GeneratedGraph grid(int rows, int cols, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<double> length{1.0, 10.0};
+
+        GeneratedGraph g{
+            "grid_" + std::to_string(rows) + "x" + std::to_string(cols),
+            rows * cols,
+            {}};
+        g.edges.reserve(static_cast<std::size_t>(rows) * cols * 4);
+
+        EdgeSet seen;
+
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < cols; ++c)
+            {
+                int v = r * cols + c;
+
+                if (c + 1 < cols)
+                {
+                    double w = length(rng);
+                    addEdge(g, seen, v, v + 1, w);
+                    addEdge(g, seen, v + 1, v, w);
+                }
+
+                if (r + 1 < rows)
+                {
+                    double w = length(rng);
+                    addEdge(g, seen, v, v + cols, w);
+                    addEdge(g, seen, v + cols, v, w);
+                }
+            }
+        }
+
+        return g;
+    }
+
+
+
+    // erdosRenyi() builds a G(n, m) random graph with n vertices and
+    // m = n * averageDegree distinct edges chosen uniformly at random,
+    // with no self-loops.
+    inline GeneratedGraph erdosRenyi(int n, int averageDegree, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{seed};
+        std::uniform_int_distribution<int> vertex{0, n - 1};
+        std::uniform_real_distribution<double> weight{1.0, 100.0};
+
+        GeneratedGraph g{
+            "erdos_renyi_n" + std::to_string(n) + "_d" + std::to_string(averageDegree),
+            n,
+            {}};
+
+        std::size_t target = static_cast<std::size_t>(n) * averageDegree;
+        std::size_t possible = static_cast<std::size_t>(n) * (n - 1);
+
+        if (target > possible)
+        {
+            target = possible;
+        }
+
+        g.edges.reserve(target);
+        EdgeSet seen;
+
+        while (g.edges.size() < target)
+        {
+            int fromV = vertex(rng);
+            int toV = vertex(rng);
+
+            if (fromV != toV)
+            {
+                addEdge(g, seen, fromV, toV, weight(rng));
+            }
+        }
+
+        return g;
+    }
+
+
+
+    // rmat() builds a power-law graph with 2^scale vertices and about
+    // edgeFactor * 2^scale edges using the recursive matrix (R-MAT)
+    // model with the usual Graph500 probabilities.  Duplicate edges and
+    // self-loops are dropped, so the edge count comes out a bit lower.
+    inline GeneratedGraph rmat(int scale, int edgeFactor, std::uint64_t seed)
+    {
+        const double a = 0.57;
+        const double b = 0.19;
+        const double c = 0.19;
+
+        std::mt19937_64 rng{seed};
+        std::uniform_real_distribution<double> unit{0.0, 1.0};
+        std::uniform_real_distribution<double> weight{1.0, 100.0};
+
+        int n = 1 << scale;
+
+        GeneratedGraph g{
+            "rmat_s" + std::to_string(scale) + "_e" + std::to_string(edgeFactor),
+            n,
+            {}};
+
+        std::size_t attempts = static_cast<std::size_t>(n) * edgeFactor;
+        g.edges.reserve(attempts);
+        EdgeSet seen;
+
+        for (std::size_t i = 0; i < attempts; ++i)
+        {
+            int fromV = 0;
+            int toV = 0;
+
+            for (int bit = scale - 1; bit >= 0; --bit)
+            {
+                double p = unit(rng);
+
+                //// The top-left quadrant (probability a) sets neither bit
+                if (p >= a + b + c)
+                {
+                    fromV |= 1 << bit;
+                    toV |= 1 << bit;
+                }
+                else if (p >= a + b)
+                {
+                    fromV |= 1 << bit;
+                }
+                else if (p >= a)
+                {
+                    toV |= 1 << bit;
+                }
+            }
+
+            if (fromV != toV)
+            {
+                addEdge(g, seen, fromV, toV, weight(rng));
+            }
+        }
+
+        return g;
+    }
+
+
+
+    // hubs() builds a graph dominated by a few heavy hub vertices
+    // (0 .. hubCount - 1): every hub has an edge to every other vertex,
+    // every other vertex has an edge back to one random hub, and each
+    // vertex also gets a few random edges.  Hub adjacency lists are as
+    // long as the graph is big, which is the worst case for anything
+    // that scans an adjacency list.
+    inline GeneratedGraph hubs(int n, int hubCount, int extraDegree, std::uint64_t seed)
+    {
+        std::mt19937_64 rng{seed};
+        std::uniform_int_distribution<int> vertex{0, n - 1};
+        std::uniform_int_distribution<int> hub{0, hubCount - 1};
+        std::uniform_real_distribution<double> weight{1.0, 100.0};
+
+        GeneratedGraph g{
+            "hubs_n" + std::to_string(n) + "_h" + std::to_string(hubCount),
+            n,
+            {}};
+
+        g.edges.reserve(static_cast<std::size_t>(n) * (hubCount + 1 + extraDegree));
+        EdgeSet seen;
+
+        for (int h = 0; h < hubCount; ++h)
+        {
+            for (int v = 0; v < n; ++v)
+            {
+                if (v != h)
+                {
+                    addEdge(g, seen, h, v, weight(rng));
+                }
+            }
+        }
+
+        for (int v = hubCount; v < n; ++v)
+        {
+            addEdge(g, seen, v, hub(rng), weight(rng));
+
+            for (int i = 0; i < extraDegree; ++i)
+            {
+                int toV = vertex(rng);
+
+                if (toV != v)
+                {
+                    addEdge(g, seen, v, toV, weight(rng));
+                }
+            }
+        }
+
+        return g;
+    }
+}
+
+
+
+#endif
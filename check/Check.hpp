@@ -0,0 +1,74 @@
+// Check.hpp
+//
+// The small harness shared by the check programs that ctest runs.  Each
+// check() prints a line when it fails, and checkSummary() turns the
+// number of failures into main()'s exit code.  (These don't use assert(),
+// since the default build type is Release and NDEBUG would turn them off.)
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <iostream>
+#include <string>
+#include "../Digraph.hpp"
+
+
+
+inline int& checkFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+
+inline void check(bool condition, const std::string& what)
+{
+    if (condition == false)
+    {
+        std::cerr << "FAILED: " << what << "\n";
+        ++checkFailures();
+    }
+}
+
+
+template <typename Function>
+bool throwsDigraphException(Function f)
+{
+    try
+    {
+        f();
+    }
+    catch (DigraphException&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+
+// The edge weight function the checks pass to findShortestPaths(), for
+// Digraphs whose EdgeInfo is the weight itself.
+inline double weightOf(const double& einfo)
+{
+    return einfo;
+}
+
+
+// checkSummary() reports how the checks went and returns main()'s exit
+// code.
+inline int checkSummary()
+{
+    if (checkFailures() != 0)
+    {
+        std::cerr << checkFailures() << " check(s) failed\n";
+        return 1;
+    }
+
+    std::cout << "all checks passed\n";
+    return 0;
+}
+
+
+
+#endif
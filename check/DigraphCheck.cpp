@@ -0,0 +1,184 @@
+// DigraphCheck.cpp
+//
+// Behavior checks for the Digraph class template, run by ctest; exits
+// nonzero if any check fails.
+
+#include <map>
+#include "../Digraph.hpp"
+#include "../bench/GraphGenerators.hpp"
+#include "Check.hpp"
+
+
+
+namespace
+{
+    void checkAddVertex()
+    {
+        Digraph<int, double> d;
+
+        //// Vertex numbers equal to the current size used to be reported
+        //// as already existing.
+        for (int v = 0; v < 4; ++v)
+        {
+            d.addVertex(v, v * 10);
+        }
+
+        check(d.vertexCount() == 4, "addVertex(n) with n == vertexCount() succeeds");
+        check(d.vertexInfo(3) == 30, "vertexInfo() returns what addVertex() stored");
+        check(throwsDigraphException([&] { d.addVertex(2, 0); }),
+            "addVertex() of an existing vertex throws");
+        check(throwsDigraphException([&] { d.vertexInfo(4); }),
+            "vertexInfo() of a missing vertex throws");
+        check(throwsDigraphException([&] { d.edgeCount(4); }),
+            "edgeCount() of a missing vertex throws");
+    }
+
+
+    void checkEdges()
+    {
+        Digraph<int, double> d;
+
+        for (int v = 0; v < 3; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        d.addEdge(0, 1, 1.5);
+        d.addEdge(0, 2, 2.5);
+        d.addEdge(1, 2, 3.5);
+
+        check(d.edgeInfo(0, 2) == 2.5, "edgeInfo() returns what addEdge() stored");
+        check(throwsDigraphException([&] { d.addEdge(0, 1, 9.0); }),
+            "addEdge() of an existing edge throws");
+        check(throwsDigraphException([&] { d.addEdge(0, 7, 9.0); }),
+            "addEdge() to a missing vertex throws");
+        check(throwsDigraphException([&] { d.edgeInfo(2, 0); }),
+            "edgeInfo() of a missing edge throws");
+        check(throwsDigraphException([&] { d.edgeInfo(7, 0); }),
+            "edgeInfo() from a missing vertex throws");
+
+        d.removeEdge(0, 1);
+        check(d.edgeCount(0) == 1 && d.edgeInfo(0, 2) == 2.5,
+            "removeEdge() removes only the given edge");
+        check(throwsDigraphException([&] { d.removeEdge(0, 1); }),
+            "removeEdge() of a missing edge throws");
+        check(throwsDigraphException([&] { d.removeEdge(0, 7); }),
+            "removeEdge() to a missing vertex throws");
+    }
+
+
+    void checkRemoveVertex()
+    {
+        GeneratedGraph g = graphgen::erdosRenyi(200, 4, 46);
+        Digraph<int, double> d;
+
+        for (int v = 0; v < g.vertexCount; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        for (const GeneratedEdge& e : g.edges)
+        {
+            d.addEdge(e.fromVertex, e.toVertex, e.weight);
+        }
+
+        const int removed = 17;
+        int inDegree = 0;
+        int outDegree = 0;
+
+        for (const GeneratedEdge& e : g.edges)
+        {
+            inDegree += e.toVertex == removed;
+            outDegree += e.fromVertex == removed;
+        }
+
+        int before = d.edgeCount();
+        d.removeVertex(removed);
+
+        check(d.vertexCount() == g.vertexCount - 1, "removeVertex() removes the vertex");
+        check(d.edgeCount() == before - inDegree - outDegree,
+            "removeVertex() removes the vertex's incoming and outgoing edges");
+        check(throwsDigraphException([&] { d.removeVertex(removed); }),
+            "removeVertex() of a missing vertex throws");
+    }
+
+
+    void checkStronglyConnected()
+    {
+        Digraph<int, double> d;
+        check(d.isStronglyConnected(), "an empty graph is strongly connected");
+
+        for (int v = 0; v < 4; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        d.addEdge(0, 1, 1.0);
+        d.addEdge(1, 2, 1.0);
+        d.addEdge(2, 3, 1.0);
+        check(d.isStronglyConnected() == false, "a path is not strongly connected");
+
+        d.addEdge(3, 0, 1.0);
+        check(d.isStronglyConnected(), "a cycle is strongly connected");
+
+        //// Everything is reachable from 0, but 0 isn't reachable from 4
+        d.addVertex(4, 4);
+        d.addEdge(0, 4, 1.0);
+        check(d.isStronglyConnected() == false,
+            "a vertex with no incoming path back is not strongly connected");
+
+        GeneratedGraph g = graphgen::grid(10, 10, 46);
+        Digraph<int, double> grid;
+
+        for (int v = 0; v < g.vertexCount; ++v)
+        {
+            grid.addVertex(v, v);
+        }
+
+        for (const GeneratedEdge& e : g.edges)
+        {
+            grid.addEdge(e.fromVertex, e.toVertex, e.weight);
+        }
+
+        check(grid.isStronglyConnected(), "a grid is strongly connected");
+    }
+
+
+    void checkShortestPaths()
+    {
+        //// 0 -> 1 -> 2 -> 3 is cheaper than the direct 0 -> 2 edge;
+        //// 4 is unreachable.
+        Digraph<int, double> d;
+
+        for (int v = 0; v < 5; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        d.addEdge(0, 1, 5.0);
+        d.addEdge(1, 2, 1.0);
+        d.addEdge(0, 2, 10.0);
+        d.addEdge(2, 3, 1.0);
+        d.addEdge(3, 0, 1.0);
+        d.addEdge(4, 0, 1.0);
+
+        std::map<int, int> expected{{0, 0}, {1, 0}, {2, 1}, {3, 2}, {4, 4}};
+        check(d.findShortestPaths(0, weightOf) == expected,
+            "findShortestPaths() picks the cheapest predecessors");
+        check(throwsDigraphException([&] { d.findShortestPaths(9, weightOf); }),
+            "findShortestPaths() from a missing vertex throws");
+    }
+}
+
+
+
+int main()
+{
+    checkAddVertex();
+    checkEdges();
+    checkRemoveVertex();
+    checkStronglyConnected();
+    checkShortestPaths();
+
+    return checkSummary();
+}
@@ -0,0 +1,204 @@
+// InstrumentationCheck.cpp
+//
+// Checks that a Digraph using CountingInstrumentation records the counts
+// it should on a small fixed graph, including counts made by a thread
+// that has already exited, and that they come out of writePrometheus().
+// Run by ctest; exits nonzero if any check fails.
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../Digraph.hpp"
+#include "Check.hpp"
+
+
+
+namespace
+{
+    using CountingGraph = Digraph<int, double, CountingInstrumentation>;
+    using Snapshot = CountingInstrumentation::Snapshot;
+
+
+    int index(DigraphOperation op)
+    {
+        return static_cast<int>(op);
+    }
+
+
+    // The fixed workload: a 4-cycle 0 -> 1 -> 2 -> 3 -> 0, one duplicate
+    // addVertex, one edgeInfo hit, one vertexCount, one edgeCount, one
+    // edgeCount(int) miss, one SCC check and one shortest paths run.
+    void workload()
+    {
+        CountingGraph d;
+
+        for (int v = 0; v < 4; ++v)
+        {
+            d.addVertex(v, v);
+        }
+
+        try
+        {
+            d.addVertex(0, 0);
+        }
+        catch (DigraphException&)
+        {
+        }
+
+        for (int v = 0; v < 4; ++v)
+        {
+            d.addEdge(v, (v + 1) % 4, 1.0);
+        }
+
+        d.edgeInfo(0, 1);
+        d.vertexCount();
+        d.edgeCount();
+
+        try
+        {
+            d.edgeCount(9);
+        }
+        catch (DigraphException&)
+        {
+        }
+
+        d.isStronglyConnected();
+        d.findShortestPaths(0, weightOf);
+    }
+
+
+    // Checks a snapshot against `runs` runs of workload()
+    void checkCounts(const Snapshot& s, std::uint64_t runs, const std::string& when)
+    {
+        check(s.calls[index(DigraphOperation::addVertex)] == 5 * runs,
+            when + ": addVertex calls");
+        check(s.exceptions[index(DigraphOperation::addVertex)] == 1 * runs,
+            when + ": addVertex exceptions");
+        check(s.calls[index(DigraphOperation::outgoingEdgeCount)] == 1 * runs
+                && s.exceptions[index(DigraphOperation::outgoingEdgeCount)] == 1 * runs,
+            when + ": edgeCount(int) calls and exceptions");
+        check(s.calls[index(DigraphOperation::vertexCount)] == 1 * runs,
+            when + ": vertexCount calls");
+        check(s.calls[index(DigraphOperation::edgeCount)] == 1 * runs
+                && s.edgesScanned[index(DigraphOperation::edgeCount)] == 4 * runs,
+            when + ": edgeCount calls and edges scanned");
+
+        //// Each addEdge goes out of a vertex with no edges yet, so the
+        //// duplicate check has nothing to scan.
+        check(s.edgesScanned[index(DigraphOperation::addEdge)] == 0,
+            when + ": addEdge edges scanned");
+        check(s.edgesScanned[index(DigraphOperation::edgeInfo)] == 1 * runs,
+            when + ": edgeInfo edges scanned");
+
+        //// Building the reversed lists, then the forward and backward
+        //// traversals, each walk all 4 edges and the last two visit all 4
+        //// vertices.
+        check(s.edgesScanned[index(DigraphOperation::isStronglyConnected)] == 12 * runs,
+            when + ": isStronglyConnected edges scanned");
+        check(s.verticesVisited == 8 * runs, when + ": isStronglyConnected vertices visited");
+
+        //// The start vertex plus one relaxation of each of the other three
+        check(s.heapPushes == 4 * runs && s.heapPops == 4 * runs,
+            when + ": findShortestPaths heap pushes and pops");
+        check(s.edgesScanned[index(DigraphOperation::findShortestPaths)] == 4 * runs,
+            when + ": findShortestPaths edges scanned");
+
+        std::uint64_t bucketTotal = 0;
+
+        for (std::uint64_t count : s.latency[index(DigraphOperation::addEdge)])
+        {
+            bucketTotal += count;
+        }
+
+        check(bucketTotal == s.calls[index(DigraphOperation::addEdge)],
+            when + ": every addEdge call lands in a latency bucket");
+    }
+
+
+    void checkLatencyBuckets()
+    {
+        check(CountingInstrumentation::latencyBucket(0) == 0, "0 ns is in bucket 0");
+        check(CountingInstrumentation::latencyBucket(1) == 0, "1 ns is in bucket 0");
+        check(CountingInstrumentation::latencyBucket(2) == 1, "2 ns is in bucket 1");
+        check(CountingInstrumentation::latencyBucket(3) == 1, "3 ns is in bucket 1");
+        check(CountingInstrumentation::latencyBucket(4) == 2, "4 ns is in bucket 2");
+        check(CountingInstrumentation::latencyBucket(~std::uint64_t{0})
+                == CountingInstrumentation::latencyBuckets - 1,
+            "huge latencies are in the last bucket");
+    }
+
+
+    // Scrapes once more during static destruction, after the registry
+    // would have been destroyed if it weren't deliberately leaked; this
+    // object is constructed before the registry, so it's destroyed after.
+    struct SnapshotAtExit
+    {
+        ~SnapshotAtExit()
+        {
+            Snapshot s = CountingInstrumentation::snapshot();
+
+            if (s.calls[index(DigraphOperation::addVertex)] != 10)
+            {
+                std::cerr << "FAILED: snapshot() during static destruction\n";
+                std::_Exit(1);
+            }
+        }
+    };
+
+    SnapshotAtExit snapshotAtExit;
+
+
+    bool contains(const std::string& text, const std::string& line)
+    {
+        return text.find(line + "\n") != std::string::npos;
+    }
+
+
+    void checkPrometheus(const Snapshot& s)
+    {
+        std::ostringstream out;
+        s.writePrometheus(out);
+        std::string text = out.str();
+
+        check(contains(text, "digraph_operation_calls_total{operation=\"addVertex\"} 10"),
+            "Prometheus export has addVertex calls");
+        check(contains(text, "digraph_operation_exceptions_total{operation=\"outgoingEdgeCount\"} 2"),
+            "Prometheus export has edgeCount(int) exceptions");
+        check(contains(text, "digraph_edges_scanned_total{operation=\"isStronglyConnected\"} 24"),
+            "Prometheus export has per-operation edges scanned");
+        check(contains(text, "digraph_operation_calls_total{operation=\"edgeCount\"} 2"),
+            "Prometheus export has edgeCount calls");
+        check(contains(text, "digraph_operation_latency_ns_bucket{operation=\"addVertex\",le=\"3\"} "
+                + std::to_string(s.latency[index(DigraphOperation::addVertex)][0]
+                    + s.latency[index(DigraphOperation::addVertex)][1])),
+            "Prometheus buckets are cumulative with inclusive le bounds");
+        check(contains(text, "digraph_operation_latency_ns_bucket{operation=\"addVertex\",le=\"+Inf\"} 10"),
+            "Prometheus +Inf bucket is the call count");
+        check(contains(text, "digraph_heap_pushes_total 8"), "Prometheus export has heap pushes");
+        check(contains(text, "digraph_vertices_visited_total 16"),
+            "Prometheus export has vertices visited");
+    }
+}
+
+
+
+int main()
+{
+    checkLatencyBuckets();
+
+    //// The first run's thread has exited by the time of the snapshot, so
+    //// its counts can only come from the registry's retired totals.
+    std::thread worker{workload};
+    worker.join();
+    checkCounts(CountingInstrumentation::snapshot(), 1, "after an exited thread");
+
+    workload();
+    Snapshot s = CountingInstrumentation::snapshot();
+    checkCounts(s, 2, "after an exited and a live thread");
+    checkPrometheus(s);
+
+    return checkSummary();
+}